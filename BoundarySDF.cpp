@@ -0,0 +1,371 @@
+#include "BoundarySDF.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+struct Edge {
+    glm::vec2 a, b;
+};
+
+const std::uint32_t kSdfMagic = 0x31464453; // "SDF1"
+const std::uint32_t kSdfVersion = 1;
+
+float point_segment_distance(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b) {
+    glm::vec2 ab = b - a;
+    float t = glm::dot(p - a, ab) / glm::dot(ab, ab);
+    t = std::min(1.0f, std::max(0.0f, t));
+    return glm::length(p - (a + ab * t));
+}
+
+// FNV-1aڸļָ
+void hash_bytes(std::uint64_t& h, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+}
+
+} // namespace
+
+std::uint64_t BoundarySDF::compute_key(const std::vector<Loop>& loops, float cell_size, float margin) {
+    std::uint64_t h = 14695981039346656037ull;
+    hash_bytes(h, &kSdfVersion, sizeof(kSdfVersion));
+    hash_bytes(h, &cell_size, sizeof(cell_size));
+    hash_bytes(h, &margin, sizeof(margin));
+    for (const auto& loop : loops) {
+        std::uint64_t n = loop.size();
+        hash_bytes(h, &n, sizeof(n));
+        for (const auto& v : loop) {
+            hash_bytes(h, &v.x, sizeof(float));
+            hash_bytes(h, &v.y, sizeof(float));
+        }
+    }
+    return h;
+}
+
+bool BoundarySDF::build(const std::vector<Loop>& loops, float cell_size, float margin) {
+    nx_ = ny_ = 0;
+    values_.clear();
+    if (cell_size <= 0.0f) {
+        std::cerr << "Error: BoundarySDF cell size must be positive" << std::endl;
+        return false;
+    }
+
+    // 1. ռбߣͬʱΧ
+    std::vector<Edge> edges;
+    glm::vec2 lo(std::numeric_limits<float>::max());
+    glm::vec2 hi(-std::numeric_limits<float>::max());
+    for (const auto& loop : loops) {
+        size_t n = loop.size();
+        if (n < 3) continue;
+        for (size_t k = 0; k < n; ++k) {
+            const glm::vec2& a = loop[k];
+            const glm::vec2& b = loop[(k + 1) % n];
+            lo = glm::min(lo, a);
+            hi = glm::max(hi, a);
+            if (a.x == b.x && a.y == b.y) continue; // ˻
+            edges.push_back({ a, b });
+        }
+    }
+    if (edges.empty()) {
+        std::cerr << "Error: BoundarySDF needs at least one closed loop" << std::endl;
+        return false;
+    }
+
+    // 2. 񣬱֤߽總Ĳֵ
+    margin = std::max(margin, 2.0f * cell_size);
+    origin_ = lo - glm::vec2(margin, margin);
+    cell_size_ = cell_size;
+    nx_ = static_cast<int>(std::ceil((hi.x - lo.x + 2.0f * margin) / cell_size)) + 1;
+    ny_ = static_cast<int>(std::ceil((hi.y - lo.y + 2.0f * margin) / cell_size)) + 1;
+    values_.assign(static_cast<size_t>(nx_) * ny_, 0.0f);
+    key_ = compute_key(loops, cell_size, margin);
+
+    const int ncx = nx_ - 1, ncy = ny_ - 1; // Ԫ
+    const float inv_cell = 1.0f / cell_size_;
+
+    // 3. ÿߵǼǵĵԪ (CSR 洢)ѯֻĸ
+    auto for_each_cell = [&](const Edge& e, auto&& fn) {
+        float ymin = std::min(e.a.y, e.b.y), ymax = std::max(e.a.y, e.b.y);
+        int cj0 = std::max(0, std::min(ncy - 1, static_cast<int>(std::floor((ymin - origin_.y) * inv_cell))));
+        int cj1 = std::max(0, std::min(ncy - 1, static_cast<int>(std::floor((ymax - origin_.y) * inv_cell))));
+        for (int cj = cj0; cj <= cj1; ++cj) {
+            // һеԪе x Χ
+            float y0 = std::max(ymin, origin_.y + cj * cell_size_);
+            float y1 = std::min(ymax, origin_.y + (cj + 1) * cell_size_);
+            float x0, x1;
+            if (e.a.y == e.b.y) {
+                x0 = std::min(e.a.x, e.b.x);
+                x1 = std::max(e.a.x, e.b.x);
+            }
+            else {
+                float s = (e.b.x - e.a.x) / (e.b.y - e.a.y);
+                float xa = e.a.x + (y0 - e.a.y) * s;
+                float xb = e.a.x + (y1 - e.a.y) * s;
+                x0 = std::min(xa, xb);
+                x1 = std::max(xa, xb);
+            }
+            int ci0 = std::max(0, std::min(ncx - 1, static_cast<int>(std::floor((x0 - origin_.x) * inv_cell))));
+            int ci1 = std::max(0, std::min(ncx - 1, static_cast<int>(std::floor((x1 - origin_.x) * inv_cell))));
+            for (int ci = ci0; ci <= ci1; ++ci) fn(cj * ncx + ci);
+        }
+    };
+
+    std::vector<int> cell_start(static_cast<size_t>(ncx) * ncy + 1, 0);
+    for (const auto& e : edges) {
+        for_each_cell(e, [&](int c) { ++cell_start[c + 1]; });
+    }
+    for (size_t c = 1; c < cell_start.size(); ++c) cell_start[c] += cell_start[c - 1];
+    std::vector<int> cell_edges(cell_start.back());
+    {
+        std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+        for (int k = 0; k < static_cast<int>(edges.size()); ++k) {
+            for_each_cell(edges[k], [&](int c) { cell_edges[fill[c]++] = k; });
+        }
+    }
+
+    // 4. ڵеǼˮƽཻıߣɨж
+    auto row_range = [&](const Edge& e, int& j0, int& j1) {
+        float ymin = std::min(e.a.y, e.b.y), ymax = std::max(e.a.y, e.b.y);
+        j0 = std::max(0, static_cast<int>(std::floor((ymin - origin_.y) * inv_cell)));
+        j1 = std::min(ny_ - 1, static_cast<int>(std::ceil((ymax - origin_.y) * inv_cell)));
+    };
+    auto crosses_row = [&](const Edge& e, int j) {
+        float y = origin_.y + j * cell_size_;
+        return (e.a.y > y) != (e.b.y > y);
+    };
+    std::vector<int> row_start(ny_ + 1, 0);
+    for (const auto& e : edges) {
+        int j0, j1;
+        row_range(e, j0, j1);
+        for (int j = j0; j <= j1; ++j) {
+            if (crosses_row(e, j)) ++row_start[j + 1];
+        }
+    }
+    for (int j = 1; j <= ny_; ++j) row_start[j] += row_start[j - 1];
+    std::vector<int> row_edges(row_start.back());
+    {
+        std::vector<int> fill(row_start.begin(), row_start.end() - 1);
+        for (int k = 0; k < static_cast<int>(edges.size()); ++k) {
+            int j0, j1;
+            row_range(edges[k], j0, j1);
+            for (int j = j0; j <= j1; ++j) {
+                if (crosses_row(edges[k], j)) row_edges[fill[j]++] = k;
+            }
+        }
+    }
+
+    // 5. խвм㾫ȷ룺ӽڵΧĸӿʼһȦȦ
+    //     r Ȧ֮ı߾Ϊ (r + 1) * cell_sizeҵļֹͣ
+    const int kBandRings = 3;
+    std::vector<int> closest(values_.size(), -1); // ÿڵ㵱ǰı
+    parallel_for(0, ny_, [&](int j) {
+        for (int i = 0; i < nx_; ++i) {
+            glm::vec2 p(origin_.x + i * cell_size_, origin_.y + j * cell_size_);
+            float best = std::numeric_limits<float>::max();
+            int best_edge = -1;
+            auto visit = [&](int ci, int cj) {
+                if (ci < 0 || ci >= ncx || cj < 0 || cj >= ncy) return;
+                int c = cj * ncx + ci;
+                for (int k = cell_start[c]; k < cell_start[c + 1]; ++k) {
+                    const Edge& e = edges[cell_edges[k]];
+                    float d = point_segment_distance(p, e.a, e.b);
+                    if (d < best) { best = d; best_edge = cell_edges[k]; }
+                }
+            };
+            for (int r = 0; r < kBandRings; ++r) {
+                int ci0 = i - 1 - r, ci1 = i + r;
+                int cj0 = j - 1 - r, cj1 = j + r;
+                for (int ci = ci0; ci <= ci1; ++ci) {
+                    visit(ci, cj0);
+                    visit(ci, cj1);
+                }
+                for (int cj = cj0 + 1; cj < cj1; ++cj) {
+                    visit(ci0, cj);
+                    visit(ci1, cj);
+                }
+                if (best <= (r + 1) * cell_size_) break;
+            }
+            size_t idx = static_cast<size_t>(j) * nx_ + i;
+            values_[idx] = best;
+            closest[idx] = best_edge;
+        }
+    });
+
+    // 6. խ⣺񴫲 (closest point propagation)
+    //    ÿڵֻѴھӵߣɨ輴ɸ
+    auto relax = [&](int i, int j, int ni, int nj) {
+        if (ni < 0 || ni >= nx_ || nj < 0 || nj >= ny_) return;
+        int k = closest[static_cast<size_t>(nj) * nx_ + ni];
+        if (k < 0) return;
+        size_t idx = static_cast<size_t>(j) * nx_ + i;
+        if (closest[idx] == k) return;
+        glm::vec2 p(origin_.x + i * cell_size_, origin_.y + j * cell_size_);
+        float d = point_segment_distance(p, edges[k].a, edges[k].b);
+        if (d < values_[idx]) { values_[idx] = d; closest[idx] = k; }
+    };
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int j = 0; j < ny_; ++j) {
+            for (int i = 0; i < nx_; ++i) {
+                relax(i, j, i - 1, j); relax(i, j, i, j - 1);
+                relax(i, j, i - 1, j - 1); relax(i, j, i + 1, j - 1);
+            }
+            for (int i = nx_ - 1; i >= 0; --i) relax(i, j, i + 1, j);
+        }
+        for (int j = ny_ - 1; j >= 0; --j) {
+            for (int i = nx_ - 1; i >= 0; --i) {
+                relax(i, j, i + 1, j); relax(i, j, i, j + 1);
+                relax(i, j, i + 1, j + 1); relax(i, j, i - 1, j + 1);
+            }
+            for (int i = 0; i < nx_; ++i) relax(i, j, i - 1, j);
+        }
+    }
+
+    // 7. вɨ + żȷţڲȡ
+    parallel_for(0, ny_, [&](int j) {
+        float y = origin_.y + j * cell_size_;
+
+        // н㣬
+        std::vector<float> xs;
+        xs.reserve(row_start[j + 1] - row_start[j]);
+        for (int k = row_start[j]; k < row_start[j + 1]; ++k) {
+            const Edge& e = edges[row_edges[k]];
+            xs.push_back(e.a.x + (y - e.a.y) * (e.b.x - e.a.x) / (e.b.y - e.a.y));
+        }
+        std::sort(xs.begin(), xs.end());
+
+        size_t crossings = 0;
+        for (int i = 0; i < nx_; ++i) {
+            float x = origin_.x + i * cell_size_;
+            while (crossings < xs.size() && xs[crossings] < x) ++crossings;
+            if (crossings % 2 == 1) values_[static_cast<size_t>(j) * nx_ + i] *= -1.0f;
+        }
+    });
+
+    std::cout << "Boundary SDF built: " << nx_ << " x " << ny_ << " grid, "
+              << edges.size() << " edges" << std::endl;
+    return true;
+}
+
+bool BoundarySDF::load_or_build(const std::vector<Loop>& loops, float cell_size, float margin,
+                                const std::string& cache_file) {
+    std::uint64_t key = compute_key(loops, cell_size, std::max(margin, 2.0f * cell_size));
+    if (load(cache_file, key)) {
+        std::cout << "Boundary SDF loaded from cache: " << cache_file << std::endl;
+        return true;
+    }
+    if (!build(loops, cell_size, margin)) return false;
+    if (!save(cache_file)) {
+        std::cerr << "Warning: Cannot write boundary SDF cache " << cache_file << std::endl;
+    }
+    return true;
+}
+
+bool BoundarySDF::save(const std::string& filename) const {
+    if (!is_valid()) return false;
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) return false;
+
+    std::int32_t nx = nx_, ny = ny_;
+    out.write(reinterpret_cast<const char*>(&kSdfMagic), sizeof(kSdfMagic));
+    out.write(reinterpret_cast<const char*>(&kSdfVersion), sizeof(kSdfVersion));
+    out.write(reinterpret_cast<const char*>(&key_), sizeof(key_));
+    out.write(reinterpret_cast<const char*>(&origin_.x), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&origin_.y), sizeof(float));
+    out.write(reinterpret_cast<const char*>(&cell_size_), sizeof(cell_size_));
+    out.write(reinterpret_cast<const char*>(&nx), sizeof(nx));
+    out.write(reinterpret_cast<const char*>(&ny), sizeof(ny));
+    out.write(reinterpret_cast<const char*>(values_.data()), values_.size() * sizeof(float));
+    return static_cast<bool>(out);
+}
+
+bool BoundarySDF::load(const std::string& filename, std::uint64_t expected_key) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) return false;
+
+    std::uint32_t magic = 0, version = 0;
+    std::uint64_t key = 0;
+    glm::vec2 origin;
+    float cell_size = 0.0f;
+    std::int32_t nx = 0, ny = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&key), sizeof(key));
+    in.read(reinterpret_cast<char*>(&origin.x), sizeof(float));
+    in.read(reinterpret_cast<char*>(&origin.y), sizeof(float));
+    in.read(reinterpret_cast<char*>(&cell_size), sizeof(cell_size));
+    in.read(reinterpret_cast<char*>(&nx), sizeof(nx));
+    in.read(reinterpret_cast<char*>(&ny), sizeof(ny));
+    if (!in || magic != kSdfMagic || version != kSdfVersion || key != expected_key) return false;
+    if (nx < 2 || ny < 2 || cell_size <= 0.0f) return false;
+
+    std::vector<float> values(static_cast<size_t>(nx) * ny);
+    in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(float));
+    if (!in) return false;
+
+    origin_ = origin;
+    cell_size_ = cell_size;
+    nx_ = nx;
+    ny_ = ny;
+    values_ = std::move(values);
+    key_ = key;
+    return true;
+}
+
+float BoundarySDF::distance(const glm::vec2& p) const {
+    glm::vec2 q = glm::clamp(p, min_corner(), max_corner());
+    float gx = (q.x - origin_.x) / cell_size_;
+    float gy = (q.y - origin_.y) / cell_size_;
+    int i = std::min(static_cast<int>(gx), nx_ - 2);
+    int j = std::min(static_cast<int>(gy), ny_ - 2);
+    float tx = gx - i, ty = gy - j;
+
+    float d0 = sample(i, j) * (1.0f - tx) + sample(i + 1, j) * tx;
+    float d1 = sample(i, j + 1) * (1.0f - tx) + sample(i + 1, j + 1) * tx;
+    return d0 * (1.0f - ty) + d1 * ty + glm::length(p - q);
+}
+
+glm::vec2 BoundarySDF::gradient(const glm::vec2& p) const {
+    glm::vec2 q = glm::clamp(p, min_corner(), max_corner());
+    glm::vec2 outside = p - q;
+    if (glm::dot(outside, outside) > 0.0f) return glm::normalize(outside);
+
+    float gx = (q.x - origin_.x) / cell_size_;
+    float gy = (q.y - origin_.y) / cell_size_;
+    int i = std::min(static_cast<int>(gx), nx_ - 2);
+    int j = std::min(static_cast<int>(gy), ny_ - 2);
+    float tx = gx - i, ty = gy - j;
+
+    // ˫ԲֵĽ
+    glm::vec2 g(
+        (sample(i + 1, j) - sample(i, j)) * (1.0f - ty) + (sample(i + 1, j + 1) - sample(i, j + 1)) * ty,
+        (sample(i, j + 1) - sample(i, j)) * (1.0f - tx) + (sample(i + 1, j + 1) - sample(i + 1, j)) * tx);
+    float len = glm::length(g);
+    return len > 1e-12f ? g / len : glm::vec2(0.0f, 0.0f);
+}
+
+bool BoundarySDF::project(glm::vec2& p, glm::vec2& normal) const {
+    normal = glm::vec2(0.0f, 0.0f);
+    float d = distance(p);
+    if (d <= 0.0f) return false;
+
+    // ݶȷˣֵϸľ볡α֤䵽ڲ
+    // ݶΪ (Χĸֵͬ) ʱûͶӰ򣬵һξΪûͶӰ
+    const float eps = 1e-3f * cell_size_;
+    bool moved = false;
+    for (int iter = 0; iter < 4 && d > 0.0f; ++iter) {
+        glm::vec2 n = gradient(p);
+        if (n.x == 0.0f && n.y == 0.0f) break;
+        normal = n;
+        p -= n * (d + eps);
+        d = distance(p);
+        moved = true;
+    }
+    return moved;
+}
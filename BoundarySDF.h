@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+// α߽磨ɴ׶зž볡
+// ڹԤ㣬ʱÿӵжϺͶӰֻһ˫Բֵ
+// ԼڲΪⲿΪ߽Ϊ 0
+class BoundarySDF {
+public:
+    // һպϻβ㲻Ҫظ
+    using Loop = std::vector<glm::vec2>;
+
+    BoundarySDF() = default;
+
+    // ɱպϻ߽ + ׶żж⣩볡
+    // cell_size Ϊ࣬margin ΪΧչľ
+    bool build(const std::vector<Loop>& loops, float cell_size, float margin);
+
+    // ȴӻļȡ治ڻ벻ƥʱ¼㲢д
+    bool load_or_build(const std::vector<Loop>& loops, float cell_size, float margin,
+                       const std::string& cache_file);
+
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename, std::uint64_t expected_key);
+
+    bool is_valid() const { return nx_ >= 2 && ny_ >= 2; }
+
+    // зž루ⲿõľƣ
+    float distance(const glm::vec2& p) const;
+
+    // 볡ĵλݶȣָⲿķ߷
+    glm::vec2 gradient(const glm::vec2& p) const;
+
+    //  p ⣬ͶӰر߽ڲಢ truenormal Ϊⷨ
+    // ûͶӰ (ڻݶΪ) ʱ falsenormal 
+    bool project(glm::vec2& p, glm::vec2& normal) const;
+
+    glm::vec2 min_corner() const { return origin_; }
+    glm::vec2 max_corner() const {
+        return origin_ + glm::vec2((nx_ - 1) * cell_size_, (ny_ - 1) * cell_size_);
+    }
+
+    // 뼸ĹϣжϻǷЧ
+    static std::uint64_t compute_key(const std::vector<Loop>& loops, float cell_size, float margin);
+
+private:
+    float sample(int i, int j) const { return values_[static_cast<size_t>(j) * nx_ + i]; }
+
+    glm::vec2 origin_ = glm::vec2(0.0f, 0.0f);
+    float cell_size_ = 1.0f;
+    int nx_ = 0, ny_ = 0;          // ڵ
+    std::vector<float> values_;    // ȴ洢Ľڵֵ
+    std::uint64_t key_ = 0;
+};
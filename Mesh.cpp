@@ -1,20 +1,33 @@
 #include "Mesh.h"
+#include "MeshSnapshot.h"
 #include <OpenMesh/Core/IO/MeshIO.hh>
 #include <iostream>
 
+Mesh::Mesh() : mesh_(std::make_unique<MyMesh>()) {}
+Mesh::~Mesh() = default;
+
 bool Mesh::load(const std::string& filename) {
-    if (!OpenMesh::IO::read_mesh(mesh_, filename)) {
+    // ʧʱһĿ
+    snapshot_.reset();
+    mesh_ = std::make_unique<MyMesh>();
+
+    if (!OpenMesh::IO::read_mesh(*mesh_, filename)) {
         std::cerr << "Error: Cannot read mesh from file " << filename << std::endl;
         return false;
     }
 
     // غһЩҪ
-    mesh_.request_face_normals();
-    mesh_.request_vertex_normals();
-    mesh_.update_normals();
+    mesh_->request_face_normals();
+    mesh_->request_vertex_normals();
+    mesh_->update_normals();
+    snapshot_ = std::make_unique<MeshSnapshot>(*mesh_);
 
     std::cout << "Mesh loaded successfully: " << std::endl;
-    std::cout << "  Vertices: " << mesh_.n_vertices() << std::endl;
-    std::cout << "  Faces: " << mesh_.n_faces() << std::endl;
+    std::cout << "  Vertices: " << mesh_->n_vertices() << std::endl;
+    std::cout << "  Faces: " << mesh_->n_faces() << std::endl;
     return true;
+}
+
+void Mesh::release_mesh_data() {
+    mesh_ = std::make_unique<MyMesh>();
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <memory>
 #include <string>
 
 // Լͣʹ
@@ -10,12 +11,23 @@ struct MyTraits : public OpenMesh::DefaultTraits
 };
 using MyMesh = OpenMesh::TriMesh_ArrayKernelT<MyTraits>;
 
+class MeshSnapshot;
+
 class Mesh {
 public:
-    Mesh() = default;
+    Mesh();
+    ~Mesh();
     bool load(const std::string& filename);
-    const MyMesh& get_mesh_data() const { return mesh_; }
+    const MyMesh& get_mesh_data() const { return *mesh_; }
+
+    // غ󹹽ֻտգѭд OpenMesh 
+    const MeshSnapshot* get_snapshot() const { return snapshot_.get(); }
+
+    // ֻҪʱͷ OpenMesh ߽ṹԽʡڴ
+    // ֮ get_mesh_data() ؿ񣬿ղӰ
+    void release_mesh_data();
 
 private:
-    MyMesh mesh_;
+    std::unique_ptr<MyMesh> mesh_;
+    std::unique_ptr<MeshSnapshot> snapshot_;
 };
\ No newline at end of file
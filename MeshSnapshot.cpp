@@ -0,0 +1,63 @@
+#include "MeshSnapshot.h"
+#include "Parallel.h"
+
+MeshSnapshot::MeshSnapshot(const MyMesh& mesh) {
+    const int nv = static_cast<int>(mesh.n_vertices());
+    const int nf = static_cast<int>(mesh.n_faces());
+
+    positions_.resize(nv);
+    vertex_normals_.resize(nv);
+    face_normals_.resize(nf);
+    face_vertices_.resize(3 * static_cast<size_t>(nf));
+    face_faces_.resize(3 * static_cast<size_t>(nf));
+    vf_offsets_.assign(nv + 1, 0);
+    vv_offsets_.assign(nv + 1, 0);
+
+    // ֻ OpenMesh̴߳ͬĶ/棬ͻ
+    // 1. ԣͬʱͳһĴС
+    parallel_for(0, nv, [&](int v) {
+        MyMesh::VertexHandle vh(v);
+        const auto& p = mesh.point(vh);
+        const auto& n = mesh.normal(vh);
+        positions_[v] = glm::vec3(p[0], p[1], p[2]);
+        vertex_normals_[v] = glm::vec3(n[0], n[1], n[2]);
+
+        std::uint32_t faces = 0, verts = 0;
+        for (auto vf = mesh.cvf_iter(vh); vf.is_valid(); ++vf) ++faces;
+        for (auto vv = mesh.cvv_iter(vh); vv.is_valid(); ++vv) ++verts;
+        vf_offsets_[v + 1] = faces;
+        vv_offsets_[v + 1] = verts;
+    });
+
+    // 2. -ڽ (ֻ)
+    parallel_for(0, nf, [&](int f) {
+        MyMesh::FaceHandle fh(f);
+        const auto& n = mesh.normal(fh);
+        face_normals_[f] = glm::vec3(n[0], n[1], n[2]);
+
+        auto heh = mesh.halfedge_handle(fh);
+        for (int k = 0; k < 3; ++k) {
+            auto opp = mesh.opposite_halfedge_handle(heh);
+            face_vertices_[3 * f + k] = static_cast<std::uint32_t>(mesh.from_vertex_handle(heh).idx());
+            face_faces_[3 * f + k] = mesh.is_boundary(opp) ? kInvalid
+                : static_cast<std::uint32_t>(mesh.face_handle(opp).idx());
+            heh = mesh.next_halfedge_handle(heh);
+        }
+    });
+
+    // 3. ǰ׺͵õ CSR ƫƣٲ
+    for (int v = 0; v < nv; ++v) {
+        vf_offsets_[v + 1] += vf_offsets_[v];
+        vv_offsets_[v + 1] += vv_offsets_[v];
+    }
+    vf_indices_.resize(vf_offsets_[nv]);
+    vv_indices_.resize(vv_offsets_[nv]);
+
+    parallel_for(0, nv, [&](int v) {
+        MyMesh::VertexHandle vh(v);
+        std::uint32_t* out = vf_indices_.data() + vf_offsets_[v];
+        for (auto vf = mesh.cvf_iter(vh); vf.is_valid(); ++vf) *out++ = static_cast<std::uint32_t>(vf->idx());
+        out = vv_indices_.data() + vv_offsets_[v];
+        for (auto vv = mesh.cvv_iter(vh); vv.is_valid(); ++vv) *out++ = static_cast<std::uint32_t>(vv->idx());
+    });
+}
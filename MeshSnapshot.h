@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+
+// MyMesh ֻտգغ󹹽һΣ֮ѭ OpenMesh İ߽ṹ
+// ݶ飬ͳһΪ 32 λڽӹϵ CSR (offsets + indices) 洢
+class MeshSnapshot {
+public:
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu; // ߽û
+
+    // һ֧ range-for
+    struct IndexRange {
+        const std::uint32_t* first;
+        const std::uint32_t* last;
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return last; }
+        std::uint32_t size() const { return static_cast<std::uint32_t>(last - first); }
+    };
+
+    explicit MeshSnapshot(const MyMesh& mesh);
+
+    std::uint32_t n_vertices() const { return static_cast<std::uint32_t>(positions_.size()); }
+    std::uint32_t n_faces() const { return static_cast<std::uint32_t>(face_normals_.size()); }
+
+    const std::vector<glm::vec3>& positions() const { return positions_; }
+    const std::vector<glm::vec3>& vertex_normals() const { return vertex_normals_; }
+    const std::vector<glm::vec3>& face_normals() const { return face_normals_; }
+
+    // ÿ 3 ֱΪϴ
+    const std::vector<std::uint32_t>& face_vertices() const { return face_vertices_; }
+
+    //  f 
+    IndexRange face_vertices(std::uint32_t f) const {
+        return { &face_vertices_[3 * f], &face_vertices_[3 * f] + 3 };
+    }
+    //  f 棬 k  (v[k], v[(k+1)%3]) ڣ߽Ϊ kInvalid
+    IndexRange face_faces(std::uint32_t f) const {
+        return { &face_faces_[3 * f], &face_faces_[3 * f] + 3 };
+    }
+    //  v һ
+    IndexRange vertex_faces(std::uint32_t v) const {
+        return { vf_indices_.data() + vf_offsets_[v], vf_indices_.data() + vf_offsets_[v + 1] };
+    }
+    //  v һڽӶ
+    IndexRange vertex_vertices(std::uint32_t v) const {
+        return { vv_indices_.data() + vv_offsets_[v], vv_indices_.data() + vv_offsets_[v + 1] };
+    }
+
+private:
+    std::vector<glm::vec3> positions_;
+    std::vector<glm::vec3> vertex_normals_;
+    std::vector<glm::vec3> face_normals_;
+
+    std::vector<std::uint32_t> face_vertices_; // 3 * n_faces
+    std::vector<std::uint32_t> face_faces_;    // 3 * n_faces
+
+    std::vector<std::uint32_t> vf_offsets_, vf_indices_; //  ->  (CSR)
+    std::vector<std::uint32_t> vv_offsets_, vv_indices_; //  ->  (CSR)
+};
@@ -0,0 +1,150 @@
+#include "Parallel.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+namespace {
+
+// ÿڵĴбгһ
+std::vector<LogicalCpu> interleave_nodes(const std::vector<std::vector<LogicalCpu>>& nodes) {
+    std::vector<LogicalCpu> order;
+    for (size_t k = 0;; ++k) {
+        bool any = false;
+        for (const auto& node : nodes) {
+            if (k < node.size()) {
+                order.push_back(node[k]);
+                any = true;
+            }
+        }
+        if (!any) break;
+    }
+    return order;
+}
+
+#ifdef __linux__
+//  sysfs  cpulist ʽ "0-23,48-71"
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        size_t dash = range.find('-');
+        int lo = std::stoi(range.substr(0, dash));
+        int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+        for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+#endif
+
+} // namespace
+
+std::vector<LogicalCpu> numa_cpu_order() {
+    std::vector<std::vector<LogicalCpu>> nodes;
+
+#ifdef _WIN32
+    // ׺ֻڽֻռһʱ壬ʱ
+    USHORT group_count = 1;
+    USHORT process_group = 0;
+    DWORD_PTR process_mask = 0, system_mask = 0;
+    bool single_group = GetProcessGroupAffinity(GetCurrentProcess(), &group_count, &process_group) &&
+                        group_count == 1 &&
+                        GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask);
+
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest)) {
+        for (ULONG n = 0; n <= highest; ++n) {
+            GROUP_AFFINITY affinity = {};
+            if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(n), &affinity)) continue;
+            KAFFINITY mask = affinity.Mask;
+            if (single_group) {
+                if (affinity.Group != process_group) continue;
+                mask &= static_cast<KAFFINITY>(process_mask);
+            }
+            std::vector<LogicalCpu> cpus;
+            for (int bit = 0; bit < static_cast<int>(sizeof(KAFFINITY) * 8); ++bit) {
+                if (mask & (KAFFINITY(1) << bit)) cpus.push_back({ affinity.Group, bit, static_cast<int>(n) });
+            }
+            if (!cpus.empty()) nodes.push_back(std::move(cpus));
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    auto is_allowed = [&](int c) {
+        return !have_mask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed));
+    };
+
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string node_list;
+    if (online && std::getline(online, node_list)) {
+        for (int n : parse_cpu_list(node_list)) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+            std::string cpu_list;
+            if (!in || !std::getline(in, cpu_list)) continue;
+            std::vector<LogicalCpu> cpus;
+            for (int c : parse_cpu_list(cpu_list)) {
+                if (is_allowed(c)) cpus.push_back({ 0, c, n });
+            }
+            if (!cpus.empty()) nodes.push_back(std::move(cpus));
+        }
+    }
+    // û sysfs Ϣ ()Ĵһڵ
+    if (nodes.empty() && have_mask) {
+        std::vector<LogicalCpu> cpus;
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) cpus.push_back({ 0, c, 0 });
+        }
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+#endif
+
+    return interleave_nodes(nodes);
+}
+
+bool pin_current_thread(const LogicalCpu& cpu) {
+#ifdef _WIN32
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = static_cast<WORD>(cpu.group);
+    affinity.Mask = KAFFINITY(1) << cpu.index;
+    if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr)) {
+        std::cerr << "Warning: Cannot pin thread to processor group " << cpu.group << " cpu " << cpu.index
+                  << " (error " << GetLastError() << ")" << std::endl;
+        return false;
+    }
+    return true;
+#elif defined(__linux__)
+    if (cpu.index < 0 || cpu.index >= CPU_SETSIZE) {
+        std::cerr << "Warning: Cannot pin thread to cpu " << cpu.index << " (out of range)" << std::endl;
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu.index, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        std::cerr << "Warning: Cannot pin thread to cpu " << cpu.index
+                  << " (" << std::strerror(err) << ")" << std::endl;
+        return false;
+    }
+    return true;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
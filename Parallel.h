@@ -0,0 +1,75 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 򵥵Ĳ for [begin, end) гĿ飬ÿ̴߳һ
+// func(i) Բͬ i 
+template <typename Func>
+void parallel_for(int begin, int end, Func func) {
+    int count = end - begin;
+    if (count <= 0) return;
+
+    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    num_threads = std::max(1, std::min(num_threads, count));
+    if (num_threads == 1) {
+        for (int i = begin; i < end; ++i) func(i);
+        return;
+    }
+
+    int chunk = (count + num_threads - 1) / num_threads;
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        int lo = begin + t * chunk;
+        int hi = std::min(end, lo + chunk);
+        if (lo >= hi) break;
+        workers.emplace_back([lo, hi, &func]() {
+            for (int i = lo; i < hi; ++i) func(i);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+// ظʹõ߳ϣcount ̶߳һ
+class Barrier {
+public:
+    explicit Barrier(int count) : count_(count), waiting_(0), generation_(0) {}
+
+    void arrive_and_wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        int gen = generation_;
+        if (++waiting_ == count_) {
+            waiting_ = 0;
+            ++generation_;
+            cv_.notify_all();
+            return;
+        }
+        cv_.wait(lock, [&]() { return gen != generation_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int count_;
+    int waiting_;
+    int generation_;
+};
+
+// һõ߼Windows ϰ (, ڱ) λLinux  group Ϊ 0
+struct LogicalCpu {
+    int group;
+    int index;
+    int node; // ڵ NUMA ڵ
+};
+
+// öٱʹõ߼ (/cgroup ׺)
+//  NUMA ڵУnode0 ĵ 0 node1 ĵ 0 node0 ĵ 1 
+// ǰ k ǾȷֲڸڵϡòʱΪڵ
+std::vector<LogicalCpu> numa_cpu_order();
+
+// ѵǰ̰߳󶨵ָϣ first-touch ߳Լڴڱؽڵ
+// ʧʱ std::cerr ϱԭ򲢷 falseֵ֧ƽֱ̨ӷ false
+bool pin_current_thread(const LogicalCpu& cpu);
@@ -8,6 +8,15 @@
 #include <sstream>
 #include <iostream>
 
+// Shader source code, read from disk separately so the (blocking) file reads
+// can run on a background thread before a GL context exists
+struct ShaderSource
+{
+    std::string vertex;
+    std::string fragment;
+    std::string error; // Non-empty if the files could not be read
+};
+
 class Shader
 {
 public:
@@ -15,39 +24,21 @@ public:
 
     // Constructor reads and builds the shader
     Shader(const char* vertexPath, const char* fragmentPath)
+        : Shader(loadSource(vertexPath, fragmentPath))
     {
-        // 1. Retrieve the vertex/fragment source code from filePath
-        std::string vertexCode;
-        std::string fragmentCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        // Ensure ifstream objects can throw exceptions:
-        vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            // Open files
-            vShaderFile.open(vertexPath);
-            fShaderFile.open(fragmentPath);
-            std::stringstream vShaderStream, fShaderStream;
-            // Read file's buffer contents into streams
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            // Close file handlers
-            vShaderFile.close();
-            fShaderFile.close();
-            // Convert stream into string
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-        }
-        catch (std::ifstream::failure& e)
+    }
+
+    // Constructor builds the shader from already loaded source code (needs a current GL context)
+    explicit Shader(const ShaderSource& source)
+    {
+        if (!source.error.empty())
         {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << source.error << std::endl;
         }
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
+        const char* vShaderCode = source.vertex.c_str();
+        const char* fShaderCode = source.fragment.c_str();
 
-        // 2. Compile shaders
+        // Compile shaders
         unsigned int vertex, fragment;
         // Vertex shader
         vertex = glCreateShader(GL_VERTEX_SHADER);
@@ -70,6 +61,39 @@ public:
         glDeleteShader(fragment);
     }
 
+    // Retrieve the vertex/fragment source code from filePath
+    // No GL calls and no console output, so it is safe to run on any thread
+    static ShaderSource loadSource(const char* vertexPath, const char* fragmentPath)
+    {
+        ShaderSource source;
+        std::ifstream vShaderFile;
+        std::ifstream fShaderFile;
+        // Ensure ifstream objects can throw exceptions:
+        vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            // Open files
+            vShaderFile.open(vertexPath);
+            fShaderFile.open(fragmentPath);
+            std::stringstream vShaderStream, fShaderStream;
+            // Read file's buffer contents into streams
+            vShaderStream << vShaderFile.rdbuf();
+            fShaderStream << fShaderFile.rdbuf();
+            // Close file handlers
+            vShaderFile.close();
+            fShaderFile.close();
+            // Convert stream into string
+            source.vertex = vShaderStream.str();
+            source.fragment = fShaderStream.str();
+        }
+        catch (std::ifstream::failure& e)
+        {
+            source.error = e.what();
+        }
+        return source;
+    }
+
     // Activate the shader
     void use() const
     {
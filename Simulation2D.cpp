@@ -1,6 +1,103 @@
 #include "Simulation2D.h"
+#include "BoundarySDF.h"
+#include "Parallel.h"
 #include <random>
 #include <algorithm> // for std::max
+#include <iostream>
+#include <limits>
+#include <thread>
+
+// ռֿ鲢ģʽ״̬ set_tiled
+struct Simulation2D::TiledState {
+    // ÿֿ鰴ж룬ⲻ֮ͬ߳α
+    struct alignas(64) Tile {
+        std::vector<Particle> particles;           // ӵеӣ̷ֻ߳д
+        std::vector<glm::vec2> halo;               // ڿð뾶ڵλø
+        std::vector<std::vector<Particle>> outbox; // ԽҪǨӣĿ
+    };
+
+    enum class Task { Scatter, Step, Migrate, Quit };
+
+    explicit TiledState(int num_tiles)
+        : tiles(num_tiles), phase_barrier(num_tiles), sync_barrier(num_tiles + 1) {}
+
+    int num_tiles() const { return static_cast<int>(tiles.size()); }
+
+    //  k  x  [lower(k), upper(k)) 
+    int find_tile(float x) const {
+        return static_cast<int>(std::upper_bound(cuts.begin(), cuts.end(), x) - cuts.begin());
+    }
+    float lower(int k) const { return k == 0 ? -std::numeric_limits<float>::infinity() : cuts[k - 1]; }
+    float upper(int k) const { return k == num_tiles() - 1 ? std::numeric_limits<float>::infinity() : cuts[k]; }
+
+    // ȡ x ķλΪֽ磬ʹÿͬ
+    void set_cuts(std::vector<float> xs) {
+        std::sort(xs.begin(), xs.end());
+        cuts.assign(num_tiles() - 1, 0.0f);
+        for (int k = 1; k < num_tiles(); ++k) {
+            cuts[k - 1] = xs.empty() ? 0.0f : xs[xs.size() * k / num_tiles()];
+        }
+    }
+
+    //  [lower - h, upper + h) Χڵλ
+    void exchange_halo(int k, float h) {
+        Tile& tile = tiles[k];
+        tile.halo.clear();
+        float lo = lower(k) - h, hi = upper(k) + h;
+        auto collect = [&](int m) {
+            for (const auto& p : tiles[m].particles) {
+                if (p.position.x >= lo && p.position.x < hi) tile.halo.push_back(p.position);
+            }
+        };
+        for (int m = k - 1; m >= 0 && upper(m) > lo; --m) collect(m);
+        for (int m = k + 1; m < num_tiles() && lower(m) < hi; ++m) collect(m);
+    }
+
+    // ѾڱӷŽ
+    void route(int k) {
+        Tile& tile = tiles[k];
+        auto& ps = tile.particles;
+        for (size_t i = 0; i < ps.size();) {
+            int dest = find_tile(ps[i].position.x);
+            if (dest != k) {
+                tile.outbox[dest].push_back(ps[i]);
+                ps[i] = ps.back();
+                ps.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    // 鷢ӣɱ߳д룬ڴڱؽڵ
+    void absorb(int k) {
+        Tile& tile = tiles[k];
+        for (int m = 0; m < num_tiles(); ++m) {
+            if (m == k) continue;
+            auto& in = tiles[m].outbox[k];
+            tile.particles.insert(tile.particles.end(), in.begin(), in.end());
+            in.clear();
+        }
+    }
+
+    // ̷߳һ񣬲ȴй߳
+    void run(Task t) {
+        task = t;
+        sync_barrier.arrive_and_wait(); // ʼ
+        sync_barrier.arrive_and_wait(); // 
+    }
+
+    std::vector<Tile> tiles;
+    std::vector<float> cuts;       // ķֽ x ꣬򣬹 num_tiles - 1 
+    std::vector<std::thread> workers;
+    Barrier phase_barrier;         // ֮߳Ľ׶ͬ
+    Barrier sync_barrier;          // ߳빤֮߳ͬ
+    Task task = Task::Quit;
+    const std::vector<Particle>* source = nullptr; // Scatter Դ
+    std::vector<LogicalCpu> cpus;  //  NUMA ڵ㽻еĿô k 󶨵 cpus[k % size]
+    int steps_since_rebalance = 0;
+};
 
 Simulation2D::Simulation2D(int num_particles, float domain_size)
     : num_particles_(num_particles), domain_size_(domain_size) {
@@ -9,13 +106,36 @@ Simulation2D::Simulation2D(int num_particles, float domain_size)
     initialize_particles();
 }
 
+Simulation2D::~Simulation2D() {
+    set_tiled(0);
+}
+
 void Simulation2D::initialize_particles() {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(0.0, domain_size_);
 
+    // жα߽ʱΧھֻܾڵĵ
+    glm::vec2 lo(0.0f, 0.0f), hi(domain_size_, domain_size_);
+    if (boundary_) {
+        lo = boundary_->min_corner();
+        hi = boundary_->max_corner();
+    }
+    std::uniform_real_distribution<float> dis_x(lo.x, hi.x);
+    std::uniform_real_distribution<float> dis_y(lo.y, hi.y);
+
     for (auto& p : particles_) {
-        p.position = glm::vec2(dis(gen), dis(gen));
+        if (boundary_) {
+            glm::vec2 normal(0.0f, 0.0f);
+            p.position = glm::vec2(dis_x(gen), dis_y(gen));
+            for (int attempt = 0; attempt < 1000 && boundary_->distance(p.position) > 0.0f; ++attempt) {
+                p.position = glm::vec2(dis_x(gen), dis_y(gen));
+            }
+            boundary_->project(p.position, normal);
+        }
+        else {
+            p.position = glm::vec2(dis(gen), dis(gen));
+        }
         p.velocity = glm::vec2(0.0f, 0.0f);
         p.force = glm::vec2(0.0f, 0.0f);
     }
@@ -31,19 +151,8 @@ void Simulation2D::compute_forces() {
     // 2. ÿһ֮ų (O(N^2) Ӷȣԭ㹻)
     for (int i = 0; i < num_particles_; ++i) {
         for (int j = i + 1; j < num_particles_; ++j) {
-            glm::vec2 diff = particles_[i].position - particles_[j].position;
-
-            //  L-infinity 
-            float dist_inf = std::max(std::abs(diff.x), std::abs(diff.y));
-
-            // ð뾶ڣʩһ򻯵ġɡ
-            if (dist_inf < h_ && dist_inf > 1e-6) {
-                float force_magnitude = stiffness_ * (h_ - dist_inf);
-
-                // ķ (L2)Ǽ򻯵
-                glm::vec2 dir = glm::normalize(diff);
-                glm::vec2 force = force_magnitude * dir;
-
+            glm::vec2 force;
+            if (pair_force(particles_[i].position - particles_[j].position, force)) {
                 particles_[i].force += force;
                 particles_[j].force -= force; // ţٵ
             }
@@ -51,6 +160,23 @@ void Simulation2D::compute_forces() {
     }
 }
 
+//  j  i ĳdiff = p_i - p_j
+bool Simulation2D::pair_force(const glm::vec2& diff, glm::vec2& force) const {
+    //  L-infinity 
+    float dist_inf = std::max(std::abs(diff.x), std::abs(diff.y));
+
+    // ð뾶ڣʩһ򻯵ġɡ
+    if (dist_inf < h_ && dist_inf > 1e-6) {
+        float force_magnitude = stiffness_ * (h_ - dist_inf);
+
+        // ķ (L2)Ǽ򻯵
+        glm::vec2 dir = glm::normalize(diff);
+        force = force_magnitude * dir;
+        return true;
+    }
+    return false;
+}
+
 //void Simulation2D::compute_forces() {
 //    for (auto& p : particles_) {
 //        p.force = glm::vec2(0.0f, 0.0f);
@@ -83,25 +209,49 @@ void Simulation2D::compute_forces() {
 //}
 
 void Simulation2D::update_positions() {
-    float mass = 1.0f; // Ϊ1
     for (auto& p : particles_) {
-        // ʹ Symplectic Euler ֣ȶ
-        p.velocity += (p.force / mass) * time_step_;
-        p.velocity *= damping_; // ʩ
-        p.position += p.velocity * time_step_;
+        integrate(p);
     }
 }
 
+void Simulation2D::integrate(Particle& p) const {
+    float mass = 1.0f; // Ϊ1
+    // ʹ Symplectic Euler ֣ȶ
+    p.velocity += (p.force / mass) * time_step_;
+    p.velocity *= damping_; // ʩ
+    p.position += p.velocity * time_step_;
+}
+
 void Simulation2D::handle_boundaries() {
     for (auto& p : particles_) {
-        if (p.position.x < 0.0f) { p.position.x = 0.0f; p.velocity.x *= -0.5f; }
-        if (p.position.x > domain_size_) { p.position.x = domain_size_; p.velocity.x *= -0.5f; }
-        if (p.position.y < 0.0f) { p.position.y = 0.0f; p.velocity.y *= -0.5f; }
-        if (p.position.y > domain_size_) { p.position.y = domain_size_; p.velocity.y *= -0.5f; }
+        apply_boundary(p);
+    }
+}
+
+void Simulation2D::apply_boundary(Particle& p) const {
+    if (boundary_) {
+        // 볡ѯ O(1) ģ߽ı޹
+        glm::vec2 normal(0.0f, 0.0f);
+        if (boundary_->project(p.position, normal)) {
+            // α߽һ£ٶȷ˥һ
+            float vn = glm::dot(p.velocity, normal);
+            if (vn > 0.0f) p.velocity -= 1.5f * vn * normal;
+        }
+        return;
     }
+
+    if (p.position.x < 0.0f) { p.position.x = 0.0f; p.velocity.x *= -0.5f; }
+    if (p.position.x > domain_size_) { p.position.x = domain_size_; p.velocity.x *= -0.5f; }
+    if (p.position.y < 0.0f) { p.position.y = 0.0f; p.velocity.y *= -0.5f; }
+    if (p.position.y > domain_size_) { p.position.y = domain_size_; p.velocity.y *= -0.5f; }
 }
 
 void Simulation2D::step() {
+    if (tiled_) {
+        step_tiled();
+        return;
+    }
+
     compute_forces();
     update_positions();
     handle_boundaries();
@@ -112,6 +262,167 @@ void Simulation2D::step() {
     }
 }
 
+void Simulation2D::set_boundary(const BoundarySDF* boundary) {
+    // ǰ˳ֿģʽµӷֲ·ֿ
+    int num_tiles = tiled_ ? static_cast<int>(tiled_->tiles.size()) : 0;
+    set_tiled(0);
+
+    boundary_ = (boundary && boundary->is_valid()) ? boundary : nullptr;
+    initialize_particles();
+    set_tiled(num_tiles);
+    for (int i = 0; i < num_particles_; ++i) {
+        positions_for_render_[i] = particles_[i].position;
+    }
+}
+
 const std::vector<glm::vec2>& Simulation2D::get_particle_positions() const {
     return positions_for_render_;
-}
\ No newline at end of file
+}
+
+// ---- ռֿ鲢ģʽ ----
+
+void Simulation2D::set_tiled(int num_tiles) {
+    if (tiled_) {
+        gather_tiles();
+        tiled_->task = TiledState::Task::Quit;
+        tiled_->sync_barrier.arrive_and_wait();
+        for (auto& w : tiled_->workers) w.join();
+        tiled_.reset();
+    }
+    if (num_tiles <= 1) return;
+
+    //  h խʱÿҪɨڿ顢 haloƿ
+    glm::vec2 lo(0.0f, 0.0f), hi(domain_size_, domain_size_);
+    if (boundary_) {
+        lo = boundary_->min_corner();
+        hi = boundary_->max_corner();
+    }
+    int max_tiles = std::max(1, static_cast<int>((hi.x - lo.x) / h_));
+    if (num_tiles > max_tiles) {
+        std::cout << "Simulation2D: " << num_tiles << " tiles would be narrower than h, using "
+                  << max_tiles << std::endl;
+        num_tiles = max_tiles;
+        if (num_tiles <= 1) return;
+    }
+
+    tiled_ = std::make_unique<TiledState>(num_tiles);
+    std::vector<float> xs;
+    xs.reserve(particles_.size());
+    for (const auto& p : particles_) xs.push_back(p.position.x);
+    tiled_->set_cuts(std::move(xs));
+    tiled_->cpus = numa_cpu_order();
+
+    for (int k = 0; k < num_tiles; ++k) {
+        tiled_->workers.emplace_back(&Simulation2D::run_tile_worker, this, k);
+    }
+
+    // ɸ߳ԼԼ (first-touch)
+    tiled_->source = &particles_;
+    tiled_->run(TiledState::Task::Scatter);
+    tiled_->source = nullptr;
+}
+
+void Simulation2D::run_tile_worker(int k) {
+    TiledState& ts = *tiled_;
+    TiledState::Tile& tile = ts.tiles[k];
+
+    // 䵽ͬ NUMA ڵϣ֮󱾿ݶ̷߳ (first-touch)
+    if (!ts.cpus.empty()) {
+        pin_current_thread(ts.cpus[k % ts.cpus.size()]);
+    }
+    tile.outbox.resize(ts.num_tiles());
+    tile.particles.reserve(2 * num_particles_ / ts.num_tiles() + 16);
+
+    for (;;) {
+        ts.sync_barrier.arrive_and_wait();
+        if (ts.task == TiledState::Task::Quit) return;
+
+        switch (ts.task) {
+        case TiledState::Task::Scatter:
+            tile.particles.clear();
+            for (const auto& p : *ts.source) {
+                if (ts.find_tile(p.position.x) == k) tile.particles.push_back(p);
+            }
+            break;
+
+        case TiledState::Task::Step:
+            // 1.  halo
+            ts.exchange_halo(k, h_);
+            ts.phase_barrier.arrive_and_wait();
+
+            // 2. ֻ㱾ܵд룬˲ţٵ
+            for (auto& p : tile.particles) {
+                p.force = glm::vec2(0.0f, 0.0f);
+                glm::vec2 force;
+                for (const auto& q : tile.particles) {
+                    if (&q != &p && pair_force(p.position - q.position, force)) p.force += force;
+                }
+                for (const auto& q : tile.halo) {
+                    if (pair_force(p.position - q, force)) p.force += force;
+                }
+            }
+            for (auto& p : tile.particles) {
+                integrate(p);
+                apply_boundary(p);
+            }
+
+            // 3. ǨԽ
+            ts.route(k);
+            ts.phase_barrier.arrive_and_wait();
+            ts.absorb(k);
+            break;
+
+        case TiledState::Task::Migrate:
+            ts.route(k);
+            ts.phase_barrier.arrive_and_wait();
+            ts.absorb(k);
+            break;
+
+        case TiledState::Task::Quit:
+            break;
+        }
+
+        ts.sync_barrier.arrive_and_wait();
+    }
+}
+
+void Simulation2D::step_tiled() {
+    tiled_->run(TiledState::Task::Step);
+
+    // Ⱦλ (˳򰴷ֿ)
+    size_t n = 0;
+    for (const auto& tile : tiled_->tiles) {
+        for (const auto& p : tile.particles) positions_for_render_[n++] = p.position;
+    }
+
+    rebalance_tiles();
+}
+
+void Simulation2D::rebalance_tiles() {
+    TiledState& ts = *tiled_;
+    // ÿ 50 żһΣ鱾ҲҪп
+    if (++ts.steps_since_rebalance < 50) return;
+    ts.steps_since_rebalance = 0;
+
+    // һ鳬ֵ (ceil(N / T)) 25% ʱ»֣ƵǨ
+    // ȡȽϣʱֵΪ 1  0
+    size_t max_count = 0;
+    for (const auto& tile : ts.tiles) max_count = std::max(max_count, tile.particles.size());
+    size_t ideal_count = (static_cast<size_t>(num_particles_) + ts.num_tiles() - 1) / ts.num_tiles();
+    if (max_count * 4 <= ideal_count * 5) return;
+
+    std::vector<float> xs;
+    xs.reserve(num_particles_);
+    for (const auto& tile : ts.tiles) {
+        for (const auto& p : tile.particles) xs.push_back(p.position.x);
+    }
+    ts.set_cuts(std::move(xs));
+    ts.run(TiledState::Task::Migrate);
+}
+
+void Simulation2D::gather_tiles() {
+    particles_.clear();
+    for (const auto& tile : tiled_->tiles) {
+        particles_.insert(particles_.end(), tile.particles.begin(), tile.particles.end());
+    }
+}
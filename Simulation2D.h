@@ -1,11 +1,15 @@
 #pragma once
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
+class BoundarySDF;
+
 class Simulation2D {
 public:
     // 캯ģС
     Simulation2D(int num_particles, float domain_size);
+    ~Simulation2D();
 
     // ִһʱ䲽ģ
     void step();
@@ -13,6 +17,15 @@ public:
     // ȡӵλãȾ
     const std::vector<glm::vec2>& get_particle_positions() const;
 
+    // α߽ (nullptr ʹĬϵ)
+    void set_boundary(const BoundarySDF* boundary);
+
+    // ռֿ鲢ģʽ x г num_tiles ÿһ̶߳ӵУ
+    // ÿ߽總 halo ӡǨԽӣʱ»
+    // ȲСð뾶 hĿᱻض (խ halo ȱ黹󣬲м)
+    // num_tiles <= 1 ʱص߳ģʽ
+    void set_tiled(int num_tiles);
+
 private:
     // ʼʱ
     void initialize_particles();
@@ -32,11 +45,25 @@ private:
         glm::vec2 force;
     };
 
+    // /ӶԵļ㣬̺߳ͷֿģʽ
+    bool pair_force(const glm::vec2& diff, glm::vec2& force) const;
+    void integrate(Particle& p) const;
+    void apply_boundary(Particle& p) const;
+
+    // ֿģʽ
+    struct TiledState;
+    void step_tiled();
+    void run_tile_worker(int k);
+    void rebalance_tiles();
+    void gather_tiles();
+    std::unique_ptr<TiledState> tiled_;
+
     std::vector<Particle> particles_;
     std::vector<glm::vec2> positions_for_render_; // 洢λã㴫GPU
 
     int num_particles_;
     float domain_size_;
+    const BoundarySDF* boundary_ = nullptr;
 
     // ģ
 	float time_step_ = 0.002f;   // ʱ䲽
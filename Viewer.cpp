@@ -1,10 +1,16 @@
 #include "Viewer.h"
+#include "MeshSnapshot.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <exception>
 #include <iostream>
 #include <vector>
 
 Viewer::Viewer(int width, int height, const std::string& title)
     : width_(width), height_(height), title_(title), window_(nullptr) {
+    // ںGLĵͬʱں̨ȡshaderԴ
+    simple_source_ = std::async(std::launch::async, Shader::loadSource, "shaders/simple.vert", "shaders/simple.frag");
+    point_source_ = std::async(std::launch::async, Shader::loadSource, "shaders/point.vert", "shaders/point.frag");
     init();
 }
 
@@ -59,7 +65,7 @@ void Viewer::set_mesh(Mesh* mesh) {
 }
 
 void Viewer::setup_buffers() {
-    if (!mesh_) return;
+    if (!mesh_ || !mesh_->get_snapshot()) return;
 
     glGenVertexArrays(1, &VAO_);
     glGenBuffers(1, &VBO_);
@@ -67,30 +73,16 @@ void Viewer::setup_buffers() {
 
     glBindVertexArray(VAO_);
 
-    // ȡ
-    const auto& mesh_data = mesh_->get_mesh_data();
-    std::vector<float> vertices;
-    vertices.reserve(mesh_data.n_vertices() * 3);
-    for (const auto& vh : mesh_data.vertices()) {
-        const auto& p = mesh_data.point(vh);
-        vertices.push_back(p[0]);
-        vertices.push_back(p[1]);
-        vertices.push_back(p[2]);
-    }
+    // еĶλú飬ֱϴ
+    const MeshSnapshot* snapshot = mesh_->get_snapshot();
+    const auto& positions = snapshot->positions();
     glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    // ȡ
-    std::vector<unsigned int> indices;
-    indices.reserve(mesh_data.n_faces() * 3);
-    for (const auto& fh : mesh_data.faces()) {
-        for (const auto& fvh : mesh_data.fv_range(fh)) {
-            indices.push_back(fvh.idx());
-        }
-    }
+    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(glm::vec3), positions.data(), GL_STATIC_DRAW);
+
+    const auto& indices = snapshot->face_vertices();
     indices_count_ = indices.size();
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint32_t), indices.data(), GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -248,14 +240,65 @@ void Viewer::update_2d_buffers() {
 }
 
 
+void Viewer::set_mesh(Mesh* mesh, std::future<bool> loaded) {
+    pending_mesh_ = mesh;
+    mesh_loaded_ = std::move(loaded);
+}
+
+void Viewer::set_simulation2d(Simulation2D* sim, std::future<void> ready) {
+    pending_sim2d_ = sim;
+    sim2d_ready_ = std::move(ready);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+}
+
+void Viewer::poll_pending() {
+    // get() ׳̨쳣 ( std::bad_allocOpenMesh ȡ쳣)
+    // ﲶ񲢱棬Ⱦѭ
+    if (pending_mesh_ && mesh_loaded_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        Mesh* mesh = pending_mesh_;
+        pending_mesh_ = nullptr;
+        try {
+            if (mesh_loaded_.get()) {
+                set_mesh(mesh);
+            }
+            else {
+                std::cerr << "Failed to load mesh in background" << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Failed to load mesh in background: " << e.what() << std::endl;
+        }
+    }
+    if (pending_sim2d_ && sim2d_ready_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        Simulation2D* sim = pending_sim2d_;
+        pending_sim2d_ = nullptr;
+        try {
+            sim2d_ready_.get();
+            set_simulation2d(sim);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Failed to prepare simulation in background: " << e.what() << std::endl;
+        }
+    }
+
+    // ڼڱʾȶɺָԭ
+    int dots = is_loading() ? static_cast<int>(glfwGetTime() * 4.0) % 4 : -1;
+    if (dots != loading_dots_) {
+        loading_dots_ = dots;
+        std::string title = title_;
+        if (dots >= 0) title += " - Loading" + std::string(dots, '.');
+        glfwSetWindowTitle(window_, title.c_str());
+    }
+}
+
 // ޸ run()  main_loop() 
 void Viewer::run() {
-    // 2D3Dزͬshader
-    if (sim2d_) {
-        point_shader_ = new Shader("shaders/point.vert", "shaders/point.frag");
+    // 2D3Dزͬshader (Դں̨ȡ)
+    if (sim2d_ || pending_sim2d_) {
+        point_shader_ = new Shader(point_source_.get());
     }
     else {
-        shader_ = new Shader("shaders/simple.vert", "shaders/simple.frag");
+        shader_ = new Shader(simple_source_.get());
     }
     update_camera_vectors();
     main_loop();
@@ -265,6 +308,11 @@ void Viewer::main_loop() {
     while (!glfwWindowShouldClose(window_)) {
         process_input();
 
+        // ̨ݾӹܣģϿʼص
+        if (is_loading()) {
+            poll_pending();
+        }
+
         // 2Dģ⣬ÿִ֡һ
         if (sim2d_) {
             sim2d_->step();
@@ -3,6 +3,7 @@
 #include <glad/glad.h>
 #include <glfw/glfw3.h>
 #include <glm/glm.hpp>
+#include <future>
 #include <string>
 
 #include "Shader.h"
@@ -24,6 +25,10 @@ public:
 
     void set_simulation2d(Simulation2D* sim);
 
+    // 첽汾ں̨׼ǰʾ״̬ɺϴGPU
+    void set_mesh(Mesh* mesh, std::future<bool> loaded);
+    void set_simulation2d(Simulation2D* sim, std::future<void> ready);
+
 private:
     // ʼ
     void init();
@@ -49,6 +54,10 @@ private:
     void setup_2d_buffers();
     void update_2d_buffers();
 
+    // ̨ɵ߳ϴGPU
+    void poll_pending();
+    bool is_loading() const { return pending_mesh_ || pending_sim2d_; }
+
 private:
     // 
     GLFWwindow* window_;
@@ -80,4 +89,12 @@ private:
     Simulation2D* sim2d_ = nullptr;
     Shader* point_shader_ = nullptr;
     unsigned int VAO_2d_ = 0, VBO_2d_ = 0;
+
+    // ̨أshader Դڴڵͬʱȡģɵ÷׼
+    std::future<ShaderSource> simple_source_, point_source_;
+    Mesh* pending_mesh_ = nullptr;
+    std::future<bool> mesh_loaded_;
+    Simulation2D* pending_sim2d_ = nullptr;
+    std::future<void> sim2d_ready_;
+    int loading_dots_ = -1; // ض״̬-1 ʾʾԭ
 };
\ No newline at end of file
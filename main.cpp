@@ -1,9 +1,14 @@
 #include "Mesh.h"
 #include "Viewer.h"
 #include "Simulation2D.h"
+#include "BoundarySDF.h"
+#include <cmath>
+#include <future>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
     // ȷĹĿ¼ bunny.obj ļ
     // Դ Stanford 3D Scanning Repository 
     const char* modelPath = "test.obj";
@@ -13,23 +18,46 @@ int main() {
     float domain_size = 5.0f;
     Simulation2D sim(num_particles, domain_size);
 
+    // --tiles N ռֿ鲢ģʽ (Ĭϵ߳)
+    int num_tiles = 0;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--tiles") == 0) num_tiles = std::atoi(argv[i + 1]);
+    }
+
+    // α߽磺߽ + мһԲο׶볡浽
+    // 볡Ķȡ/ŵ̨봰ڴshader ȡͬʱ
+    BoundarySDF boundary;
+    auto sim_ready = std::async(std::launch::async, [&]() {
+        std::vector<BoundarySDF::Loop> loops(2);
+        loops[0] = { {0.0f, 0.0f}, {domain_size, 0.0f}, {domain_size, domain_size}, {0.0f, domain_size} };
+        for (int k = 0; k < 64; ++k) {
+            float a = 2.0f * 3.14159265f * k / 64.0f;
+            loops[1].push_back(glm::vec2(domain_size / 2.0f, domain_size / 2.0f) + 1.0f * glm::vec2(std::cos(a), std::sin(a)));
+        }
+        if (boundary.load_or_build(loops, 0.02f, 0.1f, "boundary.sdf")) {
+            sim.set_boundary(&boundary);
+        }
+        sim.set_tiled(num_tiles);
+    });
+
     Viewer viewer(1280, 720, "SPH Remeshing - Stage 1.3: 2D Prototype");
-    viewer.set_simulation2d(&sim);
+    viewer.set_simulation2d(&sim, std::move(sim_ready));
     viewer.run();
 
     //Mesh mesh;
-    //if (!mesh.load(modelPath)) {
-    //    std::cerr << "Failed to load model: " << modelPath << std::endl;
-    //    // ͣһ£VS￴Ϣ
-    //    system("pause");
-    //    return -1;
-    //}
+    //// ͷ߼ŵ̨봰ڴshader ȡͬʱ
+    //// ۲ֻõգغͷ OpenMesh ߽ṹԽʡڴ
+    //auto mesh_loaded = std::async(std::launch::async, [&]() {
+    //    bool ok = mesh.load(modelPath);
+    //    mesh.release_mesh_data();
+    //    return ok;
+    //});
 
     //// һ1280x720Ĵ
     //Viewer viewer(1280, 720, "SPH Remeshing - Stage 1.2");
 
-    //// ø۲
-    //viewer.set_mesh(&mesh);
+    //// ø۲ǰʾ״̬ʧʱӡϢ
+    //viewer.set_mesh(&mesh, std::move(mesh_loaded));
 
     //// ѭ
     //viewer.run();